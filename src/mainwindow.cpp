@@ -1,12 +1,46 @@
 #include "mainwindow.h"
 #include "qdebug.h"
 #include "ui_mainwindow.h"
+#include <QClipboard>
 #include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QMenu>
+#include <QShortcut>
+#include <QSignalBlocker>
 #include <QTableWidgetItem>
 #include <algorithm>
 
 #include "serial.h"
 
+/** Removes quotes surrounding CSV field (and unescapes doubled quotes inside) */
+static QString unquote(QString field) {
+    field = field.trimmed();
+    if (field.length() > 1 && field.startsWith('"') && field.endsWith('"'))
+        field = field.mid(1, field.length() - 2).replace("\"\"", "\"");
+    return field;
+}
+
+/** Returns first CSV field (quoted fields may contain separators) without surrounding quotes */
+static QString firstField(QString text) {
+    text = text.trimmed();
+    if (text.startsWith('"')) {
+        // quoted field ends at the quote that isn't doubled
+        int end = 1;
+        while ((end = text.indexOf('"', end)) >= 0 && text.mid(end + 1, 1) == "\"")
+            end += 2;
+        return unquote(end < 0 ? text : text.left(end + 1));
+    }
+
+    // unquoted field ends at the next separator
+    int end = text.length();
+    for (const QChar c : {QChar('\t'), QChar(',')}) {
+        int index = text.indexOf(c);
+        if (index >= 0 && index < end) end = index;
+    }
+    return text.left(end).trimmed();
+}
+
 int MainWindow::mapIntToHash(int val, QHash<int, QString> *hash) {
     // if number matches, nothing needs to be done
     if (hash->contains(val)) return val;
@@ -43,6 +77,13 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
     ui->applyButton->setEnabled(false);
     updateSerialPortList();
 
+    // table context menu (revert, paste, import) and paste shortcut
+    ui->table->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(ui->table, &QTableWidget::customContextMenuRequested, this, &MainWindow::tableContextMenu);
+    QShortcut *pasteShortcut = new QShortcut(QKeySequence::Paste, ui->table);
+    pasteShortcut->setContext(Qt::WidgetShortcut);
+    connect(pasteShortcut, &QShortcut::activated, this, &MainWindow::pasteValues);
+
     // connect timer (triggered every second) - check if any data was received. If not close serial port (the device was probably plugged out)
     connect(&timer, &QTimer::timeout, [&] {
         if (!serial.isConnected()) {
@@ -155,6 +196,11 @@ bool MainWindow::updateDataTable() {
     // recreate param list (widgets were removed by table.clear)
     createParamList();
 
+    // forget changes made to the previous contents of the table
+    paramRows.clear();
+    originalValues.clear();
+    pendingChanges.clear();
+
     QApplication::processEvents();
 
     // read buffer
@@ -198,6 +244,10 @@ bool MainWindow::updateDataTable() {
                 ui->table->setItem(row, 1, val);
                 ui->table->setItem(row, 0, param);
 
+                // remember the row and its value as read from the device
+                paramRows.insert(param_s, row);
+                originalValues.append(val_s);
+
                 // reset font (as non-bold)
                 QFont f(font());
                 f.setBold(false);
@@ -222,6 +272,12 @@ bool MainWindow::updateDataTable() {
 
                 // add item to table
                 ui->table->setItem(row, 0, param);
+
+                // remember the row and its value as read from the device (for widgets overwritten below with the label
+                // shown by the widget, not the raw device value)
+                paramRows.insert(param_s, row);
+                originalValues.append(val_s);
+
                 if (paramList.value(param_s)->widget != nullptr) {
                     // if list item has widget
                     ui->table->setCellWidget(row, 1, paramList.value(param_s)->widget);
@@ -230,22 +286,22 @@ bool MainWindow::updateDataTable() {
                         QComboBox *selector = static_cast<QComboBox *>(paramList.value(param_s)->widget);
                         selector->setCurrentIndex(val_s.toUInt(nullptr, 16));
 
+                        originalValues[row] = selector->currentText();
+
                         connect(selector, &QComboBox::currentTextChanged, [&, row](QString text) {
-                            // change font as bold to mark the param as modified
-                            QFont f(font());
-                            f.setBold(true);
-                            ui->table->item(row, 0)->setFont(f);
+                            // add the param to pending changes (or remove it if original value was selected)
+                            updatePendingChange(row, text);
                         });
                     } else if (paramList.value(param_s)->type == "SelectInt") {
                         // type is select: widget is combobox, and data is decimal number
                         QComboBox *selector = static_cast<QComboBox *>(paramList.value(param_s)->widget);
                         selector->setCurrentIndex(val_s.toUInt());
 
+                        originalValues[row] = selector->currentText();
+
                         connect(selector, &QComboBox::currentTextChanged, [&, row](QString text) {
-                            // change font as bold to mark the param as modified
-                            QFont f(font());
-                            f.setBold(true);
-                            ui->table->item(row, 0)->setFont(f);
+                            // add the param to pending changes (or remove it if original value was selected)
+                            updatePendingChange(row, text);
                         });
                     } else if (paramList.value(param_s)->type == "StringHashInt+") {
                         // type is select: widget is combobox, data needs to be matched to hashmap
@@ -253,15 +309,16 @@ bool MainWindow::updateDataTable() {
                         int newVal = mapIntToHash(val_s.toInt(), paramList.value(param_s)->hash);
                         selector->setCurrentText(powerSettingsList.value(newVal));
 
+                        // keep the device value if it didn't match, so any selection differs from it
+                        if (newVal == val_s.toInt()) originalValues[row] = selector->currentText();
+
                         connect(selector, &QComboBox::currentTextChanged, [&, row](QString text) {
-                            // change font as bold to mark the param as modified
-                            QFont f(font());
-                            f.setBold(true);
-                            ui->table->item(row, 0)->setFont(f);
+                            // add the param to pending changes (or remove it if original value was selected)
+                            updatePendingChange(row, text);
                         });
 
                         // if value didn't match, it needs to be marked as modified
-                        if (newVal != val_s.toInt()) selector->currentTextChanged(selector->currentText());
+                        if (newVal != val_s.toInt()) updatePendingChange(row, selector->currentText());
                     }
                 } else
                     // item is just text
@@ -289,36 +346,36 @@ bool MainWindow::updateDataTable() {
 
 void MainWindow::applyChanges() {
     ui->table->setEnabled(false);
-    ui->statusBar->showMessage("Writing to device...");
+    ui->statusBar->showMessage("Writing " + QString::number(pendingChanges.count()) + " changes to device...");
     // for each parameter that has been modified
-    for (int r = 0; r < ui->table->rowCount(); r++)
-        if (ui->table->item(r, 0)->font().bold()) {
-            // get param name and new value
-            QByteArray param(ui->table->item(r, 0)->text().toUtf8());
-            QByteArray val;
-
-            // read data from table
-            if (advancedMode || paramList.value(param)->type == "String") {
-                // data is just text
-                val = ui->table->item(r, 1)->text().toUtf8();
-            } else if (paramList.value(param)->type == "Select") {
-                // data needs to be read from combo box (selected index), and written in HEX, adding 0x at the beginning
-                QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
-                val = ("0x" + QString::number(selector->currentIndex(), 16).toUpper()).toUtf8();
-            } else if (paramList.value(param)->type == "SelectInt") {
-                // data needs to be read from combo box (selected index), and written as number
-                QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
-                val = QString::number(selector->currentIndex()).toUtf8();
-            } else if (paramList.value(param)->type == "StringHashInt+") {
-                // data needs to be read from hashtable matching combo box selection
-                QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
-                val = ("+" + QString::number(paramList.value(param)->hash->key(selector->currentText()))).toUtf8();
-            }
-
-            // send command to modify the parameter
-            serial.send("$POGNS," + param + "=" + val + "\n");
+    for (auto change = pendingChanges.constBegin(); change != pendingChanges.constEnd(); ++change) {
+        int r = change.key();
+        // get param name and new value
+        QByteArray param(ui->table->item(r, 0)->text().toUtf8());
+        QByteArray val;
+
+        // read data from table
+        if (advancedMode || paramList.value(param)->type == "String") {
+            // data is just text
+            val = change.value().toUtf8();
+        } else if (paramList.value(param)->type == "Select") {
+            // data needs to be read from combo box (selected index), and written in HEX, adding 0x at the beginning
+            QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
+            val = ("0x" + QString::number(selector->currentIndex(), 16).toUpper()).toUtf8();
+        } else if (paramList.value(param)->type == "SelectInt") {
+            // data needs to be read from combo box (selected index), and written as number
+            QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
+            val = QString::number(selector->currentIndex()).toUtf8();
+        } else if (paramList.value(param)->type == "StringHashInt+") {
+            // data needs to be read from hashtable matching combo box selection
+            QComboBox *selector = static_cast<QComboBox *>(paramList.value(param)->widget);
+            val = ("+" + QString::number(paramList.value(param)->hash->key(selector->currentText()))).toUtf8();
         }
 
+        // send command to modify the parameter
+        serial.send("$POGNS," + param + "=" + val + "\n");
+    }
+
     // reload parameter list
     updateDataTable();
     ui->statusBar->showMessage("Changes saved");
@@ -341,12 +398,182 @@ void MainWindow::updateSerialPortList() {
     connect(ui->serialPortList, &QComboBox::currentTextChanged, this, &MainWindow::on_serialPortList_selected);
 }
 
-void MainWindow::tableCellChanged(int row, int column) {
-    // change font as bold to mark the param as modified
+void MainWindow::updatePendingChange(int row, const QString &newValue) {
+    if (row < 0 || row >= originalValues.count()) return;
+
+    bool modified = pendingChanges.contains(row);
+    if (newValue == originalValues.at(row)) {
+        // value is back to the one read from the device - nothing to write
+        if (!modified) return;
+        pendingChanges.remove(row);
+        setRowModified(row, false);
+    } else {
+        pendingChanges.insert(row, newValue);
+        if (!modified) setRowModified(row, true);
+    }
+}
+
+void MainWindow::setRowModified(int row, bool modified) {
+    // change font as bold to mark the param as modified (without triggering cellChanged)
+    const QSignalBlocker blocker(ui->table);
     QFont f(font());
-    f.setBold(true);
-    ui->table->item(row, column)->setFont(f);
+    f.setBold(modified);
     ui->table->item(row, 0)->setFont(f);
+    if (ui->table->item(row, 1) != nullptr) ui->table->item(row, 1)->setFont(f);
+}
+
+void MainWindow::revertRow(int row) {
+    if (!pendingChanges.contains(row)) return;
+
+    // restore displayed value without reporting it as a change
+    QComboBox *selector = qobject_cast<QComboBox *>(ui->table->cellWidget(row, 1));
+    if (selector != nullptr) {
+        const QSignalBlocker blocker(selector);
+        Parameter *parameter = paramList.value(ui->table->item(row, 0)->text());
+        int index = selector->findText(originalValues.at(row));
+        if (index < 0 && parameter->hash != nullptr) {
+            // device value can't be selected - go back to the closest one
+            int newVal = mapIntToHash(originalValues.at(row).toInt(), parameter->hash);
+            index = selector->findText(parameter->hash->value(newVal));
+        }
+        // index -1 clears the selection (device value was out of range)
+        selector->setCurrentIndex(index);
+
+        // if device value couldn't be restored, the row still needs to be written
+        if (selector->currentText() != originalValues.at(row)) {
+            updatePendingChange(row, selector->currentText());
+            return;
+        }
+    } else {
+        const QSignalBlocker blocker(ui->table);
+        ui->table->item(row, 1)->setText(originalValues.at(row));
+    }
+
+    pendingChanges.remove(row);
+    setRowModified(row, false);
+}
+
+int MainWindow::setValues(const QString &text, int startRow, int &rejected) {
+    int changed = 0;
+    int row = startRow;
+    rejected = 0;
+
+    // cellChanged is not needed - pending changes are updated directly
+    const QSignalBlocker blocker(ui->table);
+
+    foreach (QString line, text.split('\n')) {
+        // skip empty lines and comments
+        line = line.trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+
+        // find name / value separator
+        int sep = -1;
+        for (const QChar c : {QChar('\t'), QChar(','), QChar('=')}) {
+            int index = line.indexOf(c);
+            if (index >= 0 && (sep < 0 || index < sep)) sep = index;
+        }
+
+        // get target row and value
+        int target;
+        QString val_s;
+        if (sep >= 0) {
+            // line contains param name - unknown names (typos, header rows, params not in the table) are rejected
+            QString param_s = unquote(line.left(sep));
+            if (!paramRows.contains(param_s)) {
+                rejected++;
+                continue;
+            }
+            target = paramRows.value(param_s);
+            val_s = line.mid(sep + 1);
+        } else if (row >= 0 && row < ui->table->rowCount()) {
+            // line contains just value for the next row
+            target = row++;
+            val_s = line;
+        } else {
+            rejected++;
+            continue;
+        }
+
+        // take only the value field (further CSV fields are ignored), remove quotes (CSV) or comment (same format as
+        // the config read from the device)
+        bool quoted = val_s.trimmed().startsWith('"');
+        val_s = firstField(val_s);
+        if (!quoted) val_s = val_s.split(";").at(0).trimmed();
+
+        // value can't break $POGNS sentence (fields are separated by commas, sentence ends with new line)
+        if (val_s.contains(',') || val_s.contains('\r') || val_s.contains('\n')) {
+            rejected++;
+            continue;
+        }
+
+        // only text values can be set (rows with widgets are rejected)
+        QTableWidgetItem *item = ui->table->item(target, 1);
+        if (item == nullptr || ui->table->cellWidget(target, 1) != nullptr) {
+            rejected++;
+            continue;
+        }
+        if (item->text() == val_s) continue;
+
+        item->setText(val_s);
+        updatePendingChange(target, val_s);
+        changed++;
+    }
+    return changed;
+}
+
+void MainWindow::pasteValues() {
+    if (!advancedMode || !ui->table->isEnabled()) return;
+
+    // paste starting at the current row (or at the beginning of the table)
+    int row = std::max(ui->table->currentRow(), 0);
+    int rejected;
+    int changed = setValues(QApplication::clipboard()->text(), row, rejected);
+    ui->statusBar->showMessage(QString::number(changed) + " values pasted, " + QString::number(rejected) + " lines skipped", 5000);
+}
+
+void MainWindow::importCsv() {
+    if (!advancedMode || !ui->table->isEnabled()) return;
+
+    QString fileName = QFileDialog::getOpenFileName(this, "Import parameters", QString(), "CSV files (name,value lines) (*.csv);;All files (*)");
+    if (fileName.isEmpty()) return;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        ui->statusBar->showMessage("Cannot open " + fileName, 5000);
+        return;
+    }
+
+    // only lines with parameter names are accepted from file
+    int rejected;
+    int changed = setValues(QString::fromUtf8(file.readAll()), -1, rejected);
+    ui->statusBar->showMessage(QString::number(changed) + " values imported from " + fileName + ", " + QString::number(rejected) + " lines skipped", 5000);
+}
+
+void MainWindow::tableCellChanged(int row, int column) {
+    // only values can be edited
+    if (column != 1 || ui->table->item(row, column) == nullptr) return;
+    updatePendingChange(row, ui->table->item(row, column)->text());
+}
+
+void MainWindow::tableContextMenu(const QPoint &pos) {
+    if (!ui->table->isEnabled()) return;
+
+    int row = ui->table->rowAt(pos.y());
+    QMenu menu(this);
+
+    // revert row under the cursor / all rows
+    menu.addAction("Revert", [&, row] { revertRow(row); })->setEnabled(pendingChanges.contains(row));
+    menu.addAction("Revert all", [&] {
+            foreach (int r, pendingChanges.keys())
+                revertRow(r);
+        })->setEnabled(!pendingChanges.isEmpty());
+
+    // bulk editing (values are raw strings, available only in advanced mode)
+    menu.addSeparator();
+    menu.addAction("Paste", this, &MainWindow::pasteValues)->setEnabled(advancedMode);
+    menu.addAction("Import CSV...", this, &MainWindow::importCsv)->setEnabled(advancedMode);
+
+    menu.exec(ui->table->viewport()->mapToGlobal(pos));
 }
 
 void MainWindow::on_refreshButton_clicked() {
@@ -3,6 +3,7 @@
 #include "parameter.h"
 #include "serial.h"
 #include <QMainWindow>
+#include <QMap>
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -17,6 +18,10 @@ class MainWindow : public QMainWindow {
     bool advancedMode = false;                      // advanced mode - display all params as strings
     QHash<QString, Parameter *> paramList;          // list of parameters that should be read from the device
                                                     //
+    QHash<QString, int> paramRows;                  // table row of each displayed parameter (name -> row)
+    QList<QString> originalValues;                  // values read from the device (row -> old value)
+    QMap<int, QString> pendingChanges;              // changes waiting to be written to the device (row -> new value)
+                                                    //
     QList<QString> aircraftTypesList;               // list of aircraft types           (index -> type name)
     QList<QString> addressTypesList;                // list of address types            (index -> type name)
     QList<QString> freqTypesList;                   // list of freq types / regions     (index -> region)
@@ -41,6 +46,40 @@ class MainWindow : public QMainWindow {
     /** Reads all changed parameters from the table and sends commands to the device */
     void applyChanges();
 
+    /** Records new value of the row in the pending changes set, or drops it if it matches the value read from the device
+     * @param row      - table row
+     * @param newValue - value currently displayed in the row
+     */
+    void updatePendingChange(int row, const QString &newValue);
+
+    /** Marks / unmarks the row as modified (bold font), needs to be called only when the state changes
+     * @param row      - table row
+     * @param modified - new state of the row
+     */
+    void setRowModified(int row, bool modified);
+
+    /** Restores value read from the device in the row and removes it from the pending changes set
+     * @param row - table row
+     */
+    void revertRow(int row);
+
+    /** Sets values of multiple parameters at once (used in advanced mode)
+     * Each line is either "name<sep>value" (separator: tab, comma or '=', fields may be quoted), or just a value, which
+     * is then put into consecutive rows starting from startRow. Fields after the value are ignored. Lines with unknown
+     * names or values containing commas are skipped.
+     * @param text     - lines with values
+     * @param startRow - row for the first positional value (-1 to accept only named values)
+     * @param rejected - returns number of skipped lines
+     * @returns number of changed rows
+     */
+    int setValues(const QString &text, int startRow, int &rejected);
+
+    /** Pastes clipboard contents into the table, starting at the current row */
+    void pasteValues();
+
+    /** Asks user for a CSV file and loads its values into the table */
+    void importCsv();
+
     /** Updates contents of combobox for port selection */
     void updateSerialPortList();
 
@@ -50,6 +89,7 @@ public:
 
 private slots:
     void tableCellChanged(int row, int column);
+    void tableContextMenu(const QPoint &pos);
     void on_refreshButton_clicked();
     void on_applyButton_clicked();
     void on_serialPortList_selected(const QString &arg1);